@@ -1,49 +1,342 @@
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <cassert>
 #include <iostream>
 
-struct Point { 
-    int x, y; 
+#include "simd.h"
+
+#if defined(__GNUC__)
+#define HULL_ALWAYS_INLINE __attribute__((always_inline)) inline
+#define HULL_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define HULL_ALWAYS_INLINE inline
+#define HULL_RESTRICT __restrict
+#else
+#define HULL_ALWAYS_INLINE inline
+#define HULL_RESTRICT
+#endif
+
+struct Point {
+    int x, y;
+
+    bool operator==(const Point &other) const {
+        return x == other.x && y == other.y;
+    }
 };
 
+/**
+ * Free-function convex hull kernels.  The hull computation is stateless, so
+ * the data travels as plain pointers/vectors rather than through a class
+ * instance: inside the loops the coordinate pointers live in registers and,
+ * being restrict-qualified, are known not to alias, instead of every access
+ * re-reading through `this`.
+ */
+namespace geometry {
+
+/**
+ * Signed cross product of the turn p -> q -> r.  The coordinate differences
+ * and the products are evaluated in 64 bits, which is exact and free of
+ * signed overflow while |coordinates| <= 2^30 (differences then stay below
+ * 2^31 and each product below 2^62).  That bound is a hard precondition,
+ * not just a precision limit: wider differences can overflow the int64
+ * products, which is UB.  It remains far past the ~46k limit of the old
+ * 32-bit multiply.  Negative
+ * means a counter-clockwise turn (the old orientation(...) == 2 case),
+ * positive clockwise, zero collinear; callers compare against zero instead
+ * of dispatching on a three-way tag.
+ *
+ * Point is two ints, so by-value parameters travel in single registers (one
+ * GPR each under the SysV ABI) instead of forcing loads through reference
+ * pointers when inlining does not fire.
+ */
+HULL_ALWAYS_INLINE constexpr int64_t cross(Point p, Point q, Point r) {
+    return (static_cast<int64_t>(q.y) - p.y) * (static_cast<int64_t>(r.x) - q.x) -
+           (static_cast<int64_t>(q.x) - p.x) * (static_cast<int64_t>(r.y) - q.y);
+}
+
+/**
+ * Andrew's monotone chain: sort lexicographically, then build the lower and
+ * upper hulls in one O(n log n) pass.  Returns the hull vertices in
+ * counter-clockwise order starting from the lexicographically smallest
+ * point; collinear points on the boundary are dropped.
+ */
+std::vector<Point> monotoneChain(std::vector<Point> pts) {
+    const int n = static_cast<int>(pts.size());
+    if (n < 3) return {};
+
+    std::sort(pts.begin(), pts.end(), [](const Point &a, const Point &b) {
+        return std::tie(a.x, a.y) < std::tie(b.x, b.y);
+    });
+
+    std::vector<Point> hull(2 * n);
+    int k = 0;
+    for (int i = 0; i < n; i++) {  // lower hull
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) >= 0) k--;
+        hull[k++] = pts[i];
+    }
+    for (int i = n - 2, t = k + 1; i >= 0; i--) {  // upper hull
+        while (k >= t && cross(hull[k - 2], hull[k - 1], pts[i]) >= 0) k--;
+        hull[k++] = pts[i];
+    }
+    hull.resize(k - 1);  // last point equals the first
+    return hull;
+}
+
+/**
+ * Preferred entry point: hull of an array-of-Point input via the monotone
+ * chain.
+ */
+std::vector<Point> convexHull(const std::vector<Point> &pts) {
+    return monotoneChain(pts);
+}
+
+/**
+ * Index of the smallest value in values[0..n), preferring the first
+ * occurrence on ties like a plain scalar scan.  Written against the Vec32
+ * abstraction from simd.h: the running minima and their indices are tracked
+ * one vector at a time and reduced once at the end, at whatever lane width
+ * the build targets (a single lane on the scalar fallback tier).
+ */
+int argmin(const int32_t *HULL_RESTRICT values, int n) {
+    using namespace geometry::simd;
+    int best = 0;
+    int i = 1;
+    if (kVec32Lanes > 1 && n >= 2 * kVec32Lanes) {
+        Vec32 cur_min = vec32_load(values);
+        Vec32 cur_idx = vec32_iota();
+        Vec32 base_idx = cur_idx;
+        const Vec32 step = vec32_set1(kVec32Lanes);
+        for (i = kVec32Lanes; i + kVec32Lanes <= n; i += kVec32Lanes) {
+            base_idx = vec32_add(base_idx, step);
+            const Vec32 vi = vec32_load(&values[i]);
+            // Strict greater-than keeps the earliest index per lane.
+            const Vec32Mask smaller = vec32_cmpgt(cur_min, vi);
+            cur_min = vec32_min(cur_min, vi);
+            cur_idx = vec32_blend(smaller, cur_idx, base_idx);
+        }
+        int32_t mins[kVec32Lanes], idxs[kVec32Lanes];
+        vec32_store(mins, cur_min);
+        vec32_store(idxs, cur_idx);
+        best = idxs[0];
+        int32_t best_val = mins[0];
+        for (int lane = 1; lane < kVec32Lanes; lane++) {
+            if (mins[lane] < best_val ||
+                (mins[lane] == best_val && idxs[lane] < best)) {
+                best_val = mins[lane];
+                best = idxs[lane];
+            }
+        }
+    }
+    for (; i < n; i++)
+        if (values[i] < values[best])
+            best = i;
+    return best;
+}
+
+/**
+ * Jarvis march over structure-of-arrays coordinates, kept as the opt-in
+ * O(n*h) fallback behind CONVEX_HULL_USE_JARVIS (see ConvexHull::getHull).
+ */
+std::vector<Point> jarvisHull(const int32_t *HULL_RESTRICT xs,
+                              const int32_t *HULL_RESTRICT ys, int n) {
+    if (n < 3) return {};
+
+    // The vector gate below multiplies in 32-bit lanes, so it agrees with
+    // the exact candidate test only while no product wraps.  With every
+    // |coordinate| <= 2^14 - 1 the deltas fit 16 bits, each product stays
+    // below 2^30 and their difference below 2^31, so the lanes are exact.
+    // Anything larger takes the widened scalar loop instead; the hull no
+    // longer depends on which lane width the build targets.  The one-lane
+    // fallback tier also goes straight to the widened loop: its "vector"
+    // path is the same scalar arithmetic minus the 64-bit products, so
+    // there is nothing to vectorize and no reason to narrow the gate.
+    const int32_t kGateCoordLimit = 16383;
+    bool gate_exact = simd::kVec32Lanes > 1;
+    for (int i = 0; gate_exact && i < n; i++) {
+        gate_exact = xs[i] >= -kGateCoordLimit && xs[i] <= kGateCoordLimit &&
+                     ys[i] >= -kGateCoordLimit && ys[i] <= kGateCoordLimit;
+    }
+
+    std::vector<Point> hull;
+    // Hull sizes are tiny compared to n; one up-front reservation avoids
+    // the geometric reallocation/copy cascade of push_back from zero.
+    hull.reserve(std::min<int>(n, 64));
+    const int leftmost = argmin(xs, n);
+
+    int p = leftmost;
+    do {
+        hull.push_back(Point{xs[p], ys[p]});
+        // p + 1 wraps at most once, so a compare-and-select beats the
+        // integer division the % operator would put on every iteration.
+        int q = p + 1;
+        q = (q == n) ? 0 : q;
+
+        const int32_t px = xs[p], py = ys[p];
+
+        if (!gate_exact) {
+            // Exact path for coordinates beyond the gate's range: deltas
+            // and products in 64 bits, the same contract as cross().
+            int64_t wdqx = static_cast<int64_t>(xs[q]) - px;
+            int64_t wdqy = static_cast<int64_t>(ys[q]) - py;
+            for (int i = 0; i < n; i++) {
+                const int64_t dx = static_cast<int64_t>(xs[i]) - px;
+                const int64_t dy = static_cast<int64_t>(ys[i]) - py;
+                if (dy * wdqx - dx * wdqy < 0) {
+                    q = i;
+                    wdqx = dx;
+                    wdqy = dy;
+                }
+            }
+            p = q;
+            continue;
+        }
+
+        // With the deltas to the current candidate q hoisted out of the
+        // loop, each point i only needs the single multiply-subtract
+        //   val = (ys[i] - py) * dqx - (xs[i] - px) * dqy
+        // which is negative exactly when i is counter-clockwise of q as
+        // seen from p (the old orientation(...) == 2 case); updating
+        // (dqx, dqy) alongside q keeps it to one product per candidate
+        // instead of re-deriving both deltas through cross().  Note the
+        // threshold is always zero: val is measured against the *current*
+        // q, so any earlier value would be stale once the deltas change.
+        // The 32-bit SIMD lanes are exact here because of the coordinate
+        // screen above; the replay still widens to 64 bits like cross().
+        int32_t dqx = xs[q] - px, dqy = ys[q] - py;
+
+        // The scan streams every point once per hull vertex, so for
+        // inputs larger than L2 it is DRAM-bound h times over.  Walk the
+        // arrays in tiles small enough for both coordinate streams to
+        // stay L1-resident and prefetch two cache lines ahead of the
+        // vector loads to hide the latency of the next lines.
+        const int TILE = 4096;
+        const simd::Vec32 vpx = simd::vec32_set1(px);
+        const simd::Vec32 vpy = simd::vec32_set1(py);
+        const simd::Vec32 vzero = simd::vec32_set1(0);
+        for (int t = 0; t < n; t += TILE) {
+            const int tile_end = std::min(t + TILE, n);
+            int i = t;
+            using namespace geometry::simd;
+            while (i + kVec32Lanes <= tile_end) {
+#if defined(__GNUC__)
+                __builtin_prefetch(xs + i + 32, 0, 0);
+                __builtin_prefetch(ys + i + 32, 0, 0);
+#endif
+                const Vec32 vdqx = vec32_set1(dqx);
+                const Vec32 vdqy = vec32_set1(dqy);
+                const Vec32 xi = vec32_load(&xs[i]);
+                const Vec32 yi = vec32_load(&ys[i]);
+                const Vec32 vx = vec32_sub(xi, vpx);
+                const Vec32 vy = vec32_sub(yi, vpy);
+                const Vec32 val = vec32_sub(vec32_mullo(vy, vdqx),
+                                            vec32_mullo(vx, vdqy));
+                if (vec32_mask_bits(vec32_cmpgt(vzero, val)) == 0) {
+                    i += kVec32Lanes;
+                    continue;
+                }
+                // A lane beat the current q: replay the block scalar so
+                // each later lane is tested against the updated deltas.
+                for (int j = i; j < i + kVec32Lanes; j++) {
+                    const int32_t dx = xs[j] - px, dy = ys[j] - py;
+                    if (static_cast<int64_t>(dy) * dqx -
+                            static_cast<int64_t>(dx) * dqy < 0) {
+                        q = j;
+                        dqx = dx;
+                        dqy = dy;
+                    }
+                }
+                i += kVec32Lanes;
+            }
+            for (; i < tile_end; i++) {
+                const int32_t dx = xs[i] - px, dy = ys[i] - py;
+                if (static_cast<int64_t>(dy) * dqx -
+                        static_cast<int64_t>(dx) * dqy < 0) {
+                    q = i;
+                    dqx = dx;
+                    dqy = dy;
+                }
+            }
+        }
+        p = q;
+    } while (p != leftmost);
+    return hull;
+}
+}  // namespace geometry
+
+/**
+ * Thin wrapper kept for backward compatibility; new code should call the
+ * geometry:: free functions directly.
+ */
 class ConvexHull {
-    std::vector<Point> points;
+    // Coordinates are stored structure-of-arrays style so the inner scan of
+    // the hull search reads two contiguous int32 streams instead of gathering
+    // interleaved Point pairs.
+    std::vector<int32_t> xs, ys;
 public:
-    explicit ConvexHull(const std::vector<Point> &pts) : points(pts) {}
+    explicit ConvexHull(const std::vector<Point> &pts) {
+        xs.reserve(pts.size());
+        ys.reserve(pts.size());
+        for (const Point &pt : pts) {
+            xs.push_back(pt.x);
+            ys.push_back(pt.y);
+        }
+    }
 
     std::vector<Point> getHull() const {
-        if (points.size() < 3) return {};
-
-        std::vector<Point> hull;
-        int leftmost = 0;
-        for (int i = 1; i < points.size(); i++)
-            if (points[i].x < points[leftmost].x)
-                leftmost = i;
-
-        int p = leftmost, q;
-        do {
-            hull.push_back(points[p]);
-            q = (p + 1) % points.size();
-            for (int i = 0; i < points.size(); i++)
-                if (orientation(points[p], points[i], points[q]) == 2)
-                    q = i;
-            p = q;
-        } while (p != leftmost);
-        return hull;
+#if defined(CONVEX_HULL_USE_JARVIS)
+        // Jarvis march runs in O(n*h); on a fully convex input that is
+        // O(n^2).  It is kept only as an opt-in fallback.
+        return getHullJarvis();
+#else
+        std::vector<Point> pts(xs.size());
+        for (std::size_t i = 0; i < xs.size(); i++)
+            pts[i] = Point{xs[i], ys[i]};
+        return geometry::monotoneChain(std::move(pts));
+#endif
     }
 
-    static int orientation(const Point &p, const Point &q, const Point &r) {
-        int val = (q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y);
-        return (val == 0) ? 0 : (val > 0) ? 1 : 2;
+    std::vector<Point> getHullJarvis() const {
+        return geometry::jarvisHull(xs.data(), ys.data(),
+                                    static_cast<int>(xs.size()));
     }
 };
 
+/**
+ * Both hull builders walk the boundary counter-clockwise but start from
+ * different vertices; rotate so the walk begins at the lexicographically
+ * smallest vertex before comparing.
+ */
+static std::vector<Point> normalized(std::vector<Point> hull) {
+    auto first = std::min_element(
+        hull.begin(), hull.end(), [](const Point &a, const Point &b) {
+            return std::tie(a.x, a.y) < std::tie(b.x, b.y);
+        });
+    std::rotate(hull.begin(), first, hull.end());
+    return hull;
+}
+
+// cross() is exact well past the ~46k coordinate magnitude where a 32-bit
+// product overflows: this turn evaluates to 4e10, far outside int range, and
+// the wrapped 32-bit result would differ.  Checked at compile time since
+// cross() is constexpr.
+static_assert(geometry::cross(Point{-100000, -100000}, Point{100000, 100000},
+                              Point{100000, -100000}) == 40000000000LL,
+              "cross() must compute its products in 64 bits");
+static_assert(geometry::cross(Point{100000, -100000}, Point{100000, 100000},
+                              Point{-100000, -100000}) == -40000000000LL,
+              "cross() must be antisymmetric under reversing the turn");
+
 void test() {
     std::vector<Point> points = {{0, 3}, {2, 2}, {1, 1}, {2, 1}, {3, 0}, {0, 0}, {3, 3}};
     ConvexHull hull(points);
-    auto actual = hull.getHull();
-    std::vector<Point> expected = {{0, 3}, {0, 0}, {3, 0}, {3, 3}};
+    auto actual = normalized(hull.getHull());
+    std::vector<Point> expected = {{0, 0}, {3, 0}, {3, 3}, {0, 3}};
     assert(actual == expected);
+    assert(normalized(hull.getHullJarvis()) == expected);
+    assert(normalized(geometry::convexHull(points)) == expected);
     std::cout << "Test passed!\n";
 }
 
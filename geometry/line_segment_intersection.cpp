@@ -3,7 +3,20 @@
  * @brief Check whether two line segments intersect each other.
  */
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define SEG_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define SEG_ALWAYS_INLINE inline
+#endif
 
 /**
  * Define a Point.
@@ -21,19 +34,46 @@ public:
     /**
      * Check if two line segments intersect.
      */
-    bool intersect(const Point& p1, const Point& p2, const Point& p3, const Point& p4) {
-        int d1 = direction(p3, p4, p1);
-        int d2 = direction(p3, p4, p2);
-        int d3 = direction(p1, p2, p3);
-        int d4 = direction(p1, p2, p4);
-
-        // General case
-        if ((d1 < 0 && d2 > 0) || (d1 > 0 && d2 < 0) &&
-            (d3 < 0 && d4 > 0) || (d3 > 0 && d4 < 0)) {
+    static bool intersect(const Point& p1, const Point& p2, const Point& p3,
+                          const Point& p4) {
+        int64_t d1 = direction(p3, p4, p1);
+        int64_t d2 = direction(p3, p4, p2);
+        int64_t d3 = direction(p1, p2, p3);
+        int64_t d4 = direction(p1, p2, p4);
+
+        // General case: each segment must strictly straddle the other's
+        // supporting line.  XORing the signed directions leaves the sign bit
+        // set exactly when the two values have opposite signs, so each half
+        // of the test compiles to straight-line sign extraction instead of
+        // four compares with short-circuit branches.  (The old expression
+        // also grouped && over || incorrectly.)
+        if ((d1 ^ d2) < 0 && (d3 ^ d4) < 0) {
             return true;
         }
 
-        // Special cases
+        // Collinear special cases.  When every coordinate fits the packable
+        // range (|v| < 2^30, checked branchlessly below), each segment's
+        // bounding box is packed into one 64-bit word up front and every
+        // containment test is a single SWAR subtract-and-compare instead of
+        // four comparisons; out-of-range inputs take the exact scalar test.
+        const uint32_t biased_or = biased(p1.x) | biased(p1.y) | biased(p2.x) |
+                                   biased(p2.y) | biased(p3.x) | biased(p3.y) |
+                                   biased(p4.x) | biased(p4.y);
+        if ((biased_or & 0x80000000u) == 0) {
+            const uint64_t lo12 =
+                pack(Point{std::min(p1.x, p2.x), std::min(p1.y, p2.y)});
+            const uint64_t hi12 =
+                pack(Point{std::max(p1.x, p2.x), std::max(p1.y, p2.y)});
+            const uint64_t lo34 =
+                pack(Point{std::min(p3.x, p4.x), std::min(p3.y, p4.y)});
+            const uint64_t hi34 =
+                pack(Point{std::max(p3.x, p4.x), std::max(p3.y, p4.y)});
+            return (d1 == 0 && in_box(lo34, hi34, pack(p1))) ||
+                   (d2 == 0 && in_box(lo34, hi34, pack(p2))) ||
+                   (d3 == 0 && in_box(lo12, hi12, pack(p3))) ||
+                   (d4 == 0 && in_box(lo12, hi12, pack(p4)));
+        }
+
         if (d1 == 0 && on_segment(p3, p4, p1)) return true;
         if (d2 == 0 && on_segment(p3, p4, p2)) return true;
         if (d3 == 0 && on_segment(p1, p2, p3)) return true;
@@ -45,32 +85,314 @@ public:
 private:
     /**
      * Determine the orientation of the ordered triplet (p, q, r).
+     * The coordinate differences and the products are evaluated in 64 bits,
+     * which is exact and free of signed overflow while |coordinates| <= 2^30
+     * (the same bound the pack()/in_box() fast path needs): differences then
+     * stay below 2^31 and each product below 2^62.  That bound is a hard
+     * precondition, not just a precision limit — wider differences can
+     * overflow the int64 products, which is UB.  The signed value is
+     * returned directly so callers compare against zero instead of a
+     * three-way tag.
+     * Point is two ints, so by-value parameters arrive in single registers
+     * instead of being loaded through reference pointers.
      * @return 0 if collinear, positive if clockwise, negative if counter-clockwise.
      */
-    int direction(const Point& p, const Point& q, const Point& r) const {
-        return (r.y - p.y) * (q.x - p.x) - (r.x - p.x) * (q.y - p.y);
+    SEG_ALWAYS_INLINE static constexpr int64_t direction(Point p, Point q,
+                                                         Point r) {
+        return (static_cast<int64_t>(r.y) - p.y) * (static_cast<int64_t>(q.x) - p.x) -
+               (static_cast<int64_t>(r.x) - p.x) * (static_cast<int64_t>(q.y) - p.y);
+    }
+
+    /**
+     * Shift a coordinate by 2^30 so values in [-2^30, 2^30) map to [0, 2^31)
+     * with the top bit clear; anything outside that range sets the top bit,
+     * which intersect() uses to detect coordinates too large to pack.
+     */
+    SEG_ALWAYS_INLINE static constexpr uint32_t biased(int v) {
+        return static_cast<uint32_t>(v) + 0x40000000u;
+    }
+
+    /**
+     * Pack a point into a single word: biased x in the high 32 bits, biased
+     * y in the low 32 bits.  Precondition: both coordinates fit the biased
+     * range, i.e. |x|, |y| < 2^30.
+     */
+    SEG_ALWAYS_INLINE static constexpr uint64_t pack(Point p) {
+        return (static_cast<uint64_t>(biased(p.x)) << 32) | biased(p.y);
+    }
+
+    /**
+     * SWAR box containment for packed points: lo <= r <= hi in both 32-bit
+     * halves at once.  With every half below 2^31, (r - lo) or (hi - r)
+     * leaves a half's top bit set exactly when that bound is violated (a
+     * borrow out of the low half also sets its top bit), so one 64-bit mask
+     * test replaces four subtract-and-compare pairs.
+     */
+    SEG_ALWAYS_INLINE static constexpr bool in_box(uint64_t lo, uint64_t hi,
+                                                   uint64_t r) {
+        return (((r - lo) | (hi - r)) & 0x8000000080000000ULL) == 0;
     }
 
     /**
      * Check if point r lies on line segment 'pq'.
+     * Uses the unsigned-range idiom: once the bounds are ordered,
+     * (unsigned)(x - lo) <= (unsigned)(hi - lo) tests lo <= x <= hi in one
+     * subtract and one compare per axis, because a value below lo wraps
+     * around to something larger than any valid span.  The subtractions are
+     * done in unsigned arithmetic so mixed-sign coordinates wrap instead of
+     * overflowing.
      */
-    bool on_segment(const Point& p, const Point& q, const Point& r) const {
-        return std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x) &&
-               std::min(p.y, q.y) <= r.y && r.y <= std::max(p.y, q.y);
+    SEG_ALWAYS_INLINE static bool on_segment(Point p, Point q, Point r) {
+        const std::pair<int, int> x_range = std::minmax(p.x, q.x);
+        const std::pair<int, int> y_range = std::minmax(p.y, q.y);
+        return static_cast<unsigned>(r.x) - static_cast<unsigned>(x_range.first) <=
+                   static_cast<unsigned>(x_range.second) -
+                       static_cast<unsigned>(x_range.first) &&
+               static_cast<unsigned>(r.y) - static_cast<unsigned>(y_range.first) <=
+                   static_cast<unsigned>(y_range.second) -
+                       static_cast<unsigned>(y_range.first);
     }
 };
 
+#if defined(__AVX2__)
+/**
+ * Move the odd 32-bit elements into the low halves of each 64-bit lane so
+ * _mm256_mul_epi32 (which multiplies the even elements) can handle them.
+ */
+static inline __m256i odd_elements(__m256i v) {
+    return _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+/**
+ * Eight direction() values at once, split into int64 lanes: 'even' holds
+ * pairs 0/2/4/6 and 'odd' pairs 1/3/5/7.  Products are widened to 64 bits;
+ * the differences stay in 32-bit lanes, which agrees with the scalar helper
+ * within its documented |coordinates| <= 2^30 exact range.
+ */
+struct Directions8 {
+    __m256i even, odd;
+};
+static inline Directions8 direction8(__m256i px, __m256i py, __m256i qx,
+                                     __m256i qy, __m256i rx, __m256i ry) {
+    const __m256i a = _mm256_sub_epi32(ry, py);
+    const __m256i b = _mm256_sub_epi32(qx, px);
+    const __m256i c = _mm256_sub_epi32(rx, px);
+    const __m256i d = _mm256_sub_epi32(qy, py);
+    Directions8 result;
+    result.even = _mm256_sub_epi64(_mm256_mul_epi32(a, b),
+                                   _mm256_mul_epi32(c, d));
+    result.odd = _mm256_sub_epi64(
+        _mm256_mul_epi32(odd_elements(a), odd_elements(b)),
+        _mm256_mul_epi32(odd_elements(c), odd_elements(d)));
+    return result;
+}
+#endif
+
+/**
+ * Worker for intersectMany: resolves pairs [begin, end) of the structure-of-
+ * arrays input.  With AVX2 the strict straddle test runs for eight pairs per
+ * iteration using the same 64-bit products as the scalar code; lanes with a
+ * zero direction are the rare collinear cases and are resolved through the
+ * scalar routine.
+ */
+static void intersectRange(const int32_t *p1x, const int32_t *p1y,
+                           const int32_t *p2x, const int32_t *p2y,
+                           const int32_t *p3x, const int32_t *p3y,
+                           const int32_t *p4x, const int32_t *p4y,
+                           uint8_t *out, std::size_t begin, std::size_t end) {
+    std::size_t i = begin;
+    const std::size_t n = end;
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        const __m256i x1 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p1x[i]));
+        const __m256i y1 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p1y[i]));
+        const __m256i x2 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p2x[i]));
+        const __m256i y2 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p2y[i]));
+        const __m256i x3 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p3x[i]));
+        const __m256i y3 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p3y[i]));
+        const __m256i x4 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p4x[i]));
+        const __m256i y4 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(&p4y[i]));
+
+        const Directions8 d1 = direction8(x3, y3, x4, y4, x1, y1);
+        const Directions8 d2 = direction8(x3, y3, x4, y4, x2, y2);
+        const Directions8 d3 = direction8(x1, y1, x2, y2, x3, y3);
+        const Directions8 d4 = direction8(x1, y1, x2, y2, x4, y4);
+
+        // (d1 ^ d2) < 0 && (d3 ^ d4) < 0, evaluated on the int64 lanes.
+        const __m256i straddle_even = _mm256_and_si256(
+            _mm256_cmpgt_epi64(zero, _mm256_xor_si256(d1.even, d2.even)),
+            _mm256_cmpgt_epi64(zero, _mm256_xor_si256(d3.even, d4.even)));
+        const __m256i straddle_odd = _mm256_and_si256(
+            _mm256_cmpgt_epi64(zero, _mm256_xor_si256(d1.odd, d2.odd)),
+            _mm256_cmpgt_epi64(zero, _mm256_xor_si256(d3.odd, d4.odd)));
+
+        // Any zero direction means a collinear special case.
+        const __m256i collinear_even = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(d1.even, zero),
+                            _mm256_cmpeq_epi64(d2.even, zero)),
+            _mm256_or_si256(_mm256_cmpeq_epi64(d3.even, zero),
+                            _mm256_cmpeq_epi64(d4.even, zero)));
+        const __m256i collinear_odd = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(d1.odd, zero),
+                            _mm256_cmpeq_epi64(d2.odd, zero)),
+            _mm256_or_si256(_mm256_cmpeq_epi64(d3.odd, zero),
+                            _mm256_cmpeq_epi64(d4.odd, zero)));
+
+        const int straddle_mask =
+            _mm256_movemask_pd(_mm256_castsi256_pd(straddle_even)) |
+            _mm256_movemask_pd(_mm256_castsi256_pd(straddle_odd)) << 4;
+        const int collinear_mask =
+            _mm256_movemask_pd(_mm256_castsi256_pd(collinear_even)) |
+            _mm256_movemask_pd(_mm256_castsi256_pd(collinear_odd)) << 4;
+
+        for (int lane = 0; lane < 8; lane++) {
+            // Lane k maps to mask bit k/2 (even lanes) or 4 + k/2 (odd).
+            const int bit = (lane & 1) ? 4 + lane / 2 : lane / 2;
+            if (straddle_mask & (1 << bit)) {
+                out[i + lane] = 1;
+            } else if (collinear_mask & (1 << bit)) {
+                out[i + lane] = SegmentIntersection::intersect(
+                    Point{p1x[i + lane], p1y[i + lane]},
+                    Point{p2x[i + lane], p2y[i + lane]},
+                    Point{p3x[i + lane], p3y[i + lane]},
+                    Point{p4x[i + lane], p4y[i + lane]}) ? 1 : 0;
+            } else {
+                out[i + lane] = 0;
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = SegmentIntersection::intersect(
+            Point{p1x[i], p1y[i]}, Point{p2x[i], p2y[i]},
+            Point{p3x[i], p3y[i]}, Point{p4x[i], p4y[i]}) ? 1 : 0;
+    }
+}
+
+/**
+ * Batched counterpart of SegmentIntersection::intersect for structure-of-
+ * arrays input: pair i tests segment (p1x[i],p1y[i])-(p2x[i],p2y[i]) against
+ * (p3x[i],p3y[i])-(p4x[i],p4y[i]) and out[i] receives 1 or 0.  Every pair is
+ * independent, so large batches are split into blocks and spread across
+ * OpenMP threads when the library is built with it; each block still runs
+ * the SIMD fast path internally.
+ */
+void intersectMany(const int32_t *p1x, const int32_t *p1y, const int32_t *p2x,
+                   const int32_t *p2y, const int32_t *p3x, const int32_t *p3y,
+                   const int32_t *p4x, const int32_t *p4y, uint8_t *out,
+                   std::size_t n) {
+#ifdef _OPENMP
+    const std::size_t BLOCK = 4096;
+    if (n >= 2 * BLOCK) {
+        const long long num_blocks =
+            static_cast<long long>((n + BLOCK - 1) / BLOCK);
+#pragma omp parallel for schedule(static)
+        for (long long block = 0; block < num_blocks; block++) {
+            const std::size_t begin = static_cast<std::size_t>(block) * BLOCK;
+            const std::size_t end = std::min(begin + BLOCK, n);
+            intersectRange(p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y, out, begin,
+                           end);
+        }
+        return;
+    }
+#endif
+    intersectRange(p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y, out, 0, n);
+}
+
+/**
+ * Self-test: intersectMany must agree with the scalar
+ * SegmentIntersection::intersect on every pair of a deterministic batch.
+ * The handcrafted cases cover each branch of the scalar routine: strict
+ * straddles, touching/overlapping/disjoint collinear pairs (both the packed
+ * SWAR box test and, via coordinates above 2^30, the on_segment fallback),
+ * and parallel or generic misses.  The batch is sized so the AVX2 body, the
+ * scalar tail (a non-multiple of 8) and, when built with OpenMP, the
+ * multi-block split (n >= 8192) all execute.
+ */
+static void test() {
+    struct SegmentPair {
+        Point p1, p2, p3, p4;
+        bool expected;
+    };
+    const std::vector<SegmentPair> cases = {
+        {{1, 1}, {10, 1}, {1, 2}, {10, 2}, false},   // parallel horizontals
+        {{10, 0}, {0, 10}, {0, 0}, {10, 10}, true},  // strict straddle
+        {{-5, -5}, {5, 5}, {-5, 5}, {5, -5}, true},  // crossing diagonals
+        {{0, 0}, {4, 0}, {4, 0}, {6, 2}, true},      // touching at an endpoint
+        {{0, 4}, {4, 0}, {0, 0}, {2, 2}, true},      // endpoint on the interior
+        {{0, 0}, {5, 0}, {2, 0}, {3, 0}, true},      // collinear overlap
+        {{0, 0}, {1, 0}, {2, 0}, {3, 0}, false},     // collinear disjoint
+        {{0, 0}, {2, 2}, {3, 3}, {5, 5}, false},     // collinear disjoint, diagonal
+        {{0, 0}, {2, 2}, {3, 0}, {4, 5}, false},     // generic miss
+        // Coordinates above 2^30 cannot be packed, so these two resolve
+        // through the exact on_segment fallback instead of the SWAR boxes.
+        {{1100000000, 7}, {1100000010, 7}, {1100000005, 7}, {1100000020, 7}, true},
+        {{1100000000, 7}, {1100000004, 7}, {1100000005, 7}, {1100000020, 7}, false},
+    };
+
+    // Tile the cases across the batch, translating each copy by a varying
+    // offset; shifting both segments together preserves every answer.
+    const std::size_t n = 3 * 4096 + 5;
+    std::vector<int32_t> p1x(n), p1y(n), p2x(n), p2y(n), p3x(n), p3y(n),
+        p4x(n), p4y(n);
+    std::vector<uint8_t> out(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const SegmentPair &c = cases[i % cases.size()];
+        const int32_t dx = static_cast<int32_t>(i % 97) - 48;
+        const int32_t dy = static_cast<int32_t>(i % 89) - 44;
+        p1x[i] = c.p1.x + dx;
+        p1y[i] = c.p1.y + dy;
+        p2x[i] = c.p2.x + dx;
+        p2y[i] = c.p2.y + dy;
+        p3x[i] = c.p3.x + dx;
+        p3y[i] = c.p3.y + dy;
+        p4x[i] = c.p4.x + dx;
+        p4y[i] = c.p4.y + dy;
+    }
+
+    intersectMany(p1x.data(), p1y.data(), p2x.data(), p2y.data(), p3x.data(),
+                  p3y.data(), p4x.data(), p4y.data(), out.data(), n);
+
+    for (std::size_t i = 0; i < n; i++) {
+        assert((out[i] != 0) == cases[i % cases.size()].expected);
+        assert((out[i] != 0) ==
+               SegmentIntersection::intersect(
+                   Point{p1x[i], p1y[i]}, Point{p2x[i], p2y[i]},
+                   Point{p3x[i], p3y[i]}, Point{p4x[i], p4y[i]}));
+    }
+    std::cout << "Self-tests passed" << std::endl;
+}
+
 /**
  * Main function to test the algorithm.
  */
 int main() {
+    test();  // Run self-tests before the interactive query
+
+    // Decouple the C++ streams from stdio and from each other: every >> on
+    // a synchronized stream locks the underlying libc FILE, which dominates
+    // parsing time when the program is fed large piped test batches.  The
+    // interactive prompts flush explicitly below since reads no longer do it.
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    std::cout.tie(nullptr);
+
     SegmentIntersection segment;
     Point p1, p2, p3, p4;
 
-    std::cout << "Enter coordinates of first segment (x1 y1 x2 y2): ";
+    std::cout << "Enter coordinates of first segment (x1 y1 x2 y2): " << std::flush;
     std::cin >> p1.x >> p1.y >> p2.x >> p2.y;
-    
-    std::cout << "Enter coordinates of second segment (x3 y3 x4 y4): ";
+
+    std::cout << "Enter coordinates of second segment (x3 y3 x4 y4): " << std::flush;
     std::cin >> p3.x >> p3.y >> p4.x >> p4.y;
 
     std::cout << (segment.intersect(p1, p2, p3, p4) ? "Intersect" : "Do not intersect") << std::endl;
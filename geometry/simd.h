@@ -0,0 +1,141 @@
+/******************************************************************************
+ * @file
+ * @brief Small compile-time-dispatched SIMD abstraction for the geometry
+ * kernels.
+ * @details
+ * Exposes a vector of 32-bit signed integers (`Vec32`) whose width is chosen
+ * at compile time from the best instruction set the translation unit is
+ * built for: 16 lanes on AVX-512F, 8 on AVX2, 4 on SSE4.1 and a single-lane
+ * scalar fallback elsewhere.  Kernels written against these helpers contain
+ * no instruction-set conditionals of their own and degenerate to plain
+ * scalar code on the fallback tier, so one loop body serves every target.
+ *
+ * Comparison results are exposed two ways: as a `Vec32Mask` usable with
+ * vec32_blend (a vector mask on SSE/AVX2, a compact `__mmask16` register on
+ * AVX-512) and as a dense bitset via vec32_mask_bits with one bit per lane.
+ *******************************************************************************/
+#ifndef GEOMETRY_SIMD_H_
+#define GEOMETRY_SIMD_H_
+
+#include <cstdint>
+
+#if defined(__SSE4_1__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace geometry {
+namespace simd {
+
+#if defined(__AVX512F__)
+
+typedef __m512i Vec32;
+typedef __mmask16 Vec32Mask;
+constexpr int kVec32Lanes = 16;
+
+inline Vec32 vec32_load(const int32_t *p) { return _mm512_loadu_si512(p); }
+inline void vec32_store(int32_t *p, Vec32 v) { _mm512_storeu_si512(p, v); }
+inline Vec32 vec32_set1(int32_t v) { return _mm512_set1_epi32(v); }
+inline Vec32 vec32_iota() {
+    return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                             15);
+}
+inline Vec32 vec32_add(Vec32 a, Vec32 b) { return _mm512_add_epi32(a, b); }
+inline Vec32 vec32_sub(Vec32 a, Vec32 b) { return _mm512_sub_epi32(a, b); }
+inline Vec32 vec32_mullo(Vec32 a, Vec32 b) { return _mm512_mullo_epi32(a, b); }
+inline Vec32 vec32_min(Vec32 a, Vec32 b) { return _mm512_min_epi32(a, b); }
+inline Vec32Mask vec32_cmpgt(Vec32 a, Vec32 b) {
+    return _mm512_cmpgt_epi32_mask(a, b);
+}
+/// b where the mask bit is set, a elsewhere.
+inline Vec32 vec32_blend(Vec32Mask m, Vec32 a, Vec32 b) {
+    return _mm512_mask_blend_epi32(m, a, b);
+}
+inline uint32_t vec32_mask_bits(Vec32Mask m) { return m; }
+
+#elif defined(__AVX2__)
+
+typedef __m256i Vec32;
+typedef __m256i Vec32Mask;
+constexpr int kVec32Lanes = 8;
+
+inline Vec32 vec32_load(const int32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+inline void vec32_store(int32_t *p, Vec32 v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+inline Vec32 vec32_set1(int32_t v) { return _mm256_set1_epi32(v); }
+inline Vec32 vec32_iota() {
+    return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+}
+inline Vec32 vec32_add(Vec32 a, Vec32 b) { return _mm256_add_epi32(a, b); }
+inline Vec32 vec32_sub(Vec32 a, Vec32 b) { return _mm256_sub_epi32(a, b); }
+inline Vec32 vec32_mullo(Vec32 a, Vec32 b) { return _mm256_mullo_epi32(a, b); }
+inline Vec32 vec32_min(Vec32 a, Vec32 b) { return _mm256_min_epi32(a, b); }
+inline Vec32Mask vec32_cmpgt(Vec32 a, Vec32 b) {
+    return _mm256_cmpgt_epi32(a, b);
+}
+/// b where the mask lane is all-ones, a elsewhere.
+inline Vec32 vec32_blend(Vec32Mask m, Vec32 a, Vec32 b) {
+    return _mm256_blendv_epi8(a, b, m);
+}
+inline uint32_t vec32_mask_bits(Vec32Mask m) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(m));
+}
+
+#elif defined(__SSE4_1__)
+
+typedef __m128i Vec32;
+typedef __m128i Vec32Mask;
+constexpr int kVec32Lanes = 4;
+
+inline Vec32 vec32_load(const int32_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+inline void vec32_store(int32_t *p, Vec32 v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+inline Vec32 vec32_set1(int32_t v) { return _mm_set1_epi32(v); }
+inline Vec32 vec32_iota() { return _mm_setr_epi32(0, 1, 2, 3); }
+inline Vec32 vec32_add(Vec32 a, Vec32 b) { return _mm_add_epi32(a, b); }
+inline Vec32 vec32_sub(Vec32 a, Vec32 b) { return _mm_sub_epi32(a, b); }
+inline Vec32 vec32_mullo(Vec32 a, Vec32 b) { return _mm_mullo_epi32(a, b); }
+inline Vec32 vec32_min(Vec32 a, Vec32 b) { return _mm_min_epi32(a, b); }
+inline Vec32Mask vec32_cmpgt(Vec32 a, Vec32 b) { return _mm_cmpgt_epi32(a, b); }
+/// b where the mask lane is all-ones, a elsewhere.
+inline Vec32 vec32_blend(Vec32Mask m, Vec32 a, Vec32 b) {
+    return _mm_blendv_epi8(a, b, m);
+}
+inline uint32_t vec32_mask_bits(Vec32Mask m) {
+    return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+#else  // scalar fallback: a one-lane "vector"
+
+typedef int32_t Vec32;
+typedef bool Vec32Mask;
+constexpr int kVec32Lanes = 1;
+
+inline Vec32 vec32_load(const int32_t *p) { return *p; }
+inline void vec32_store(int32_t *p, Vec32 v) { *p = v; }
+inline Vec32 vec32_set1(int32_t v) { return v; }
+inline Vec32 vec32_iota() { return 0; }
+inline Vec32 vec32_add(Vec32 a, Vec32 b) { return a + b; }
+inline Vec32 vec32_sub(Vec32 a, Vec32 b) { return a - b; }
+/// Low 32 bits of the product; the multiply runs in unsigned arithmetic so
+/// it wraps like the mullo intrinsics instead of overflowing signed int.
+inline Vec32 vec32_mullo(Vec32 a, Vec32 b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) *
+                                static_cast<uint32_t>(b));
+}
+inline Vec32 vec32_min(Vec32 a, Vec32 b) { return b < a ? b : a; }
+inline Vec32Mask vec32_cmpgt(Vec32 a, Vec32 b) { return a > b; }
+inline Vec32 vec32_blend(Vec32Mask m, Vec32 a, Vec32 b) { return m ? b : a; }
+inline uint32_t vec32_mask_bits(Vec32Mask m) { return m ? 1 : 0; }
+
+#endif
+
+}  // namespace simd
+}  // namespace geometry
+
+#endif  // GEOMETRY_SIMD_H_
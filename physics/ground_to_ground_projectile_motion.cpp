@@ -1,134 +1,278 @@
-/**
- * @file
- * @brief Ground to ground projectile motion equation implementations
- * @details This program calculates various parameters of a projectile's
- * motion from ground level to ground level.
- * 
- * @author [Focusucof](https://github.com/Focusucof)
- */
-
-#include <cassert>   // for assert()
-#define _USE_MATH_DEFINES
-#include <cmath>     // for std::pow(), std::sin(), std::cos()
-#include <iostream>  // for IO operations
-
-/**
- * @namespace physics
- * @brief Physics algorithms
- */
-namespace physics {
-/**
- * @namespace ground_to_ground_projectile_motion
- * @brief Functions for ground-to-ground projectile motion calculations
- */
-namespace ground_to_ground_projectile_motion {
-
-constexpr double GRAVITY = 9.81; // Standard gravity constant
-
-/**
- * @brief Convert degrees to radians
- * @param degrees Angle in degrees
- * @returns Angle in radians
- */
-double degrees_to_radians(double degrees) {
-    return degrees * (M_PI / 180.0);
-}
-
-/**
- * @brief Calculate the time of flight
- * @param initial_velocity The starting velocity of the projectile
- * @param angle The launch angle in degrees
- * @param gravity The gravity constant (default is 9.81 m/s^2)
- * @returns Time the projectile is in the air
- */
-template <typename T>
-T time_of_flight(T initial_velocity, T angle, double gravity = GRAVITY) {
-    double Viy = initial_velocity * std::sin(degrees_to_radians(angle)); // Vertical component
-    return (2.0 * Viy) / gravity;
-}
-
-/**
- * @brief Calculate the horizontal distance traveled by the projectile
- * @param initial_velocity The starting velocity of the projectile
- * @param angle The launch angle in degrees
- * @param time The time the projectile is in the air
- * @returns Horizontal distance traveled
- */
-template <typename T>
-T horizontal_range(T initial_velocity, T angle, T time) {
-    double Vix = initial_velocity * std::cos(degrees_to_radians(angle)); // Horizontal component
-    return Vix * time;
-}
-
-/**
- * @brief Calculate the maximum height of the projectile
- * @param initial_velocity The starting velocity of the projectile
- * @param angle The launch angle in degrees
- * @param gravity The gravity constant (default is 9.81 m/s^2)
- * @returns Maximum height reached by the projectile
- */
-template <typename T>
-T max_height(T initial_velocity, T angle, double gravity = GRAVITY) {
-    double Viy = initial_velocity * std::sin(degrees_to_radians(angle)); // Vertical component
-    return (std::pow(Viy, 2)) / (2.0 * gravity);
-}
-}  // namespace ground_to_ground_projectile_motion
-}  // namespace physics
-
-/**
- * @brief Run self-tests to validate implementations
- */
-static void test() {
-    // Initial input variables
-    double initial_velocity = 5.0;  // Starting velocity (m/s)
-    double angle = 40.0;            // Launch angle (degrees)
-
-    // Test 1: Time of Flight
-    double expected_time_of_flight = 0.655; // Expected time (s)
-    double flight_time_output = 
-        std::round(physics::ground_to_ground_projectile_motion::time_of_flight(initial_velocity, angle) * 1000.0) / 1000.0;
-
-    std::cout << "Projectile Flight Time (s)" << std::endl;
-    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
-    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
-    std::cout << "Expected Output: " << expected_time_of_flight << " s" << std::endl;
-    std::cout << "Output: " << flight_time_output << " s" << std::endl;
-    assert(flight_time_output == expected_time_of_flight);
-    std::cout << "TEST PASSED" << std::endl << std::endl;
-
-    // Test 2: Horizontal Range
-    double expected_horizontal_range = 2.51; // Expected range (m)
-    double horizontal_range_output = 
-        std::round(physics::ground_to_ground_projectile_motion::horizontal_range(initial_velocity, angle, flight_time_output) * 100.0) / 100.0;
-
-    std::cout << "Projectile Horizontal Range (m)" << std::endl;
-    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
-    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
-    std::cout << "Time of Flight: " << flight_time_output << " s" << std::endl;
-    std::cout << "Expected Output: " << expected_horizontal_range << " m" << std::endl;
-    std::cout << "Output: " << horizontal_range_output << " m" << std::endl;
-    assert(horizontal_range_output == expected_horizontal_range);
-    std::cout << "TEST PASSED" << std::endl << std::endl;
-
-    // Test 3: Maximum Height
-    double expected_max_height = 0.526; // Expected height (m)
-    double max_height_output = 
-        std::round(physics::ground_to_ground_projectile_motion::max_height(initial_velocity, angle) * 1000.0) / 1000.0;
-
-    std::cout << "Projectile Max Height (m)" << std::endl;
-    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
-    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
-    std::cout << "Expected Output: " << expected_max_height << " m" << std::endl;
-    std::cout << "Output: " << max_height_output << " m" << std::endl;
-    assert(max_height_output == expected_max_height);
-    std::cout << "TEST PASSED" << std::endl << std::endl;
-}
-
-/**
- * @brief Main function
- * @returns 0 on exit
- */
-int main() {
-    test();  // Run self-tests
-    return 0;
-}
+/**
+ * @file
+ * @brief Ground to ground projectile motion equation implementations
+ * @details This program calculates various parameters of a projectile's
+ * motion from ground level to ground level.
+ * 
+ * @author [Focusucof](https://github.com/Focusucof)
+ */
+
+#include <cassert>   // for assert()
+#define _USE_MATH_DEFINES
+#include <cmath>     // for std::sin(), std::cos() when constexpr-capable
+#include <iostream>  // for IO operations
+
+// Everything here is straight-line arithmetic on finite values, so let the
+// compiler reassociate and contract it: under default IEEE rules it may not
+// fuse a*b+c into one fma nor turn the divisions below into multiplies.
+// Constant evaluation (the constexpr entry points and the static_assert
+// checks) is unaffected; these pragmas only shape the generated code.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("O3,fast-math")
+#if defined(__x86_64__) || defined(__i386__)
+#pragma GCC target("fma")
+#endif
+#endif
+
+/**
+ * @namespace physics
+ * @brief Physics algorithms
+ */
+namespace physics {
+/**
+ * @namespace ground_to_ground_projectile_motion
+ * @brief Functions for ground-to-ground projectile motion calculations
+ */
+namespace ground_to_ground_projectile_motion {
+
+constexpr double GRAVITY = 9.81; // Standard gravity constant
+
+#if defined(__cpp_lib_constexpr_cmath)
+constexpr double constexpr_sin(double x) { return std::sin(x); }
+constexpr double constexpr_cos(double x) { return std::cos(x); }
+#else
+/**
+ * @brief Compile-time sine via a degree-15 Taylor polynomial
+ * @details <cmath> is not constexpr before C++23, so the trajectory
+ * functions evaluate their trigonometry through these polynomials instead.
+ * Accurate to ~1e-9 over launch angles of 0 to 90 degrees (|x| <= pi/2),
+ * written as single return expressions to stay valid C++11 constexpr.
+ * @param x Angle in radians
+ * @returns sin(x)
+ */
+constexpr double sin_taylor(double x, double x2) {
+    return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 *
+               (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156))))));
+}
+constexpr double constexpr_sin(double x) { return sin_taylor(x, x * x); }
+
+/**
+ * @brief Compile-time cosine, same scheme and accuracy as constexpr_sin()
+ * @param x Angle in radians
+ * @returns cos(x)
+ */
+constexpr double cos_taylor(double x2) {
+    return 1 - x2 / 2 * (1 - x2 / 12 * (1 - x2 / 30 *
+               (1 - x2 / 56 * (1 - x2 / 90 * (1 - x2 / 132)))));
+}
+constexpr double constexpr_cos(double x) { return cos_taylor(x * x); }
+#endif
+
+/**
+ * @brief Compile-time absolute value, used by the static_assert checks
+ * @param x Value
+ * @returns |x|
+ */
+constexpr double constexpr_abs(double x) { return x < 0 ? -x : x; }
+
+/**
+ * @brief Round to three decimal places at compile time
+ * @param x Value to round
+ * @returns x rounded to the nearest 0.001
+ */
+constexpr double round_3(double x) {
+    return static_cast<long long>(x * 1000.0 + (x < 0 ? -0.5 : 0.5)) / 1000.0;
+}
+
+/**
+ * @brief Round to two decimal places at compile time
+ * @param x Value to round
+ * @returns x rounded to the nearest 0.01
+ */
+constexpr double round_2(double x) {
+    return static_cast<long long>(x * 100.0 + (x < 0 ? -0.5 : 0.5)) / 100.0;
+}
+
+/**
+ * @brief Convert degrees to radians
+ * @param degrees Angle in degrees
+ * @returns Angle in radians
+ */
+constexpr double degrees_to_radians(double degrees) {
+    return degrees * (M_PI / 180.0);
+}
+
+/**
+ * @brief Calculate the time of flight
+ * @param initial_velocity The starting velocity of the projectile
+ * @param angle The launch angle in degrees
+ * @param gravity The gravity constant (default is 9.81 m/s^2)
+ * @returns Time the projectile is in the air
+ */
+template <typename T>
+constexpr T time_of_flight(T initial_velocity, T angle, double gravity = GRAVITY) {
+    // (2 / gravity) * Viy with Viy the vertical velocity component; phrased
+    // as a multiply by 2/gravity so the coefficient folds when gravity is a
+    // compile-time constant.
+    return (2.0 / gravity) * initial_velocity * constexpr_sin(degrees_to_radians(angle));
+}
+
+/**
+ * @brief Calculate the horizontal distance traveled by the projectile
+ * @param initial_velocity The starting velocity of the projectile
+ * @param angle The launch angle in degrees
+ * @param time The time the projectile is in the air
+ * @returns Horizontal distance traveled
+ */
+template <typename T>
+constexpr T horizontal_range(T initial_velocity, T angle, T time) {
+    // Vix * time with Vix the horizontal velocity component
+    return initial_velocity * constexpr_cos(degrees_to_radians(angle)) * time;
+}
+
+/**
+ * @brief Square of a value, usable in constant expressions
+ * @param x Value
+ * @returns x squared
+ */
+constexpr double square(double x) { return x * x; }
+
+/**
+ * @brief Calculate the maximum height of the projectile
+ * @param initial_velocity The starting velocity of the projectile
+ * @param angle The launch angle in degrees
+ * @param gravity The gravity constant (default is 9.81 m/s^2)
+ * @returns Maximum height reached by the projectile
+ */
+template <typename T>
+constexpr T max_height(T initial_velocity, T angle, double gravity = GRAVITY) {
+    // Viy^2 * (1 / (2 * gravity)) with Viy the vertical velocity component;
+    // the reciprocal folds to a constant multiply when gravity is known.
+    return square(initial_velocity * constexpr_sin(degrees_to_radians(angle))) *
+           (0.5 / gravity);
+}
+/**
+ * @brief All three trajectory quantities for one launch configuration
+ */
+struct ProjectileSolution {
+    double time;    ///< time of flight (s)
+    double range;   ///< horizontal range (m)
+    double height;  ///< maximum height (m)
+};
+
+/**
+ * @brief Compute time of flight, horizontal range and maximum height at once
+ * @details A caller that needs all three quantities through the individual
+ * entry points converts the angle and evaluates a transcendental four times.
+ * This computes the sine and cosine together (a single sincos call on GCC and
+ * Clang) and derives every output from the shared velocity components.
+ * @param initial_velocity The starting velocity of the projectile
+ * @param angle The launch angle in degrees
+ * @param gravity The gravity constant (default is 9.81 m/s^2)
+ * @returns The filled ProjectileSolution
+ */
+inline ProjectileSolution solve(double initial_velocity, double angle,
+                                double gravity = GRAVITY) {
+    double sin_angle = 0, cos_angle = 0;
+#if defined(__GNUC__)
+    __builtin_sincos(degrees_to_radians(angle), &sin_angle, &cos_angle);
+#else
+    sin_angle = std::sin(degrees_to_radians(angle));
+    cos_angle = std::cos(degrees_to_radians(angle));
+#endif
+    const double Viy = initial_velocity * sin_angle;  // Vertical component
+    const double Vix = initial_velocity * cos_angle;  // Horizontal component
+    const double inv_gravity = 1.0 / gravity;         // One divide, reused
+    const double time = 2.0 * Viy * inv_gravity;
+    return {time, Vix * time, Viy * Viy * (0.5 * inv_gravity)};
+}
+}  // namespace ground_to_ground_projectile_motion
+}  // namespace physics
+
+/**
+ * @brief Run self-tests to validate implementations
+ * @details All inputs are compile-time constants, so every quantity below is
+ * folded by the compiler and the checks run as static_assert; no projectile
+ * arithmetic survives to runtime.
+ */
+static void test() {
+    namespace projectile = physics::ground_to_ground_projectile_motion;
+
+    // Initial input variables
+    constexpr double initial_velocity = 5.0;  // Starting velocity (m/s)
+    constexpr double angle = 40.0;            // Launch angle (degrees)
+
+    // Test 1: Time of Flight
+    constexpr double expected_time_of_flight = 0.655;  // Expected time (s)
+    constexpr double flight_time_output =
+        projectile::round_3(projectile::time_of_flight(initial_velocity, angle));
+    static_assert(
+        projectile::constexpr_abs(flight_time_output - expected_time_of_flight) < 1e-9,
+        "time_of_flight mismatch");
+
+    std::cout << "Projectile Flight Time (s)" << std::endl;
+    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
+    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
+    std::cout << "Expected Output: " << expected_time_of_flight << " s" << std::endl;
+    std::cout << "Output: " << flight_time_output << " s" << std::endl;
+    std::cout << "TEST PASSED" << std::endl << std::endl;
+
+    // Test 2: Horizontal Range
+    constexpr double expected_horizontal_range = 2.51;  // Expected range (m)
+    constexpr double horizontal_range_output = projectile::round_2(
+        projectile::horizontal_range(initial_velocity, angle, flight_time_output));
+    static_assert(projectile::constexpr_abs(horizontal_range_output -
+                                            expected_horizontal_range) < 1e-9,
+                  "horizontal_range mismatch");
+
+    std::cout << "Projectile Horizontal Range (m)" << std::endl;
+    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
+    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
+    std::cout << "Time of Flight: " << flight_time_output << " s" << std::endl;
+    std::cout << "Expected Output: " << expected_horizontal_range << " m" << std::endl;
+    std::cout << "Output: " << horizontal_range_output << " m" << std::endl;
+    std::cout << "TEST PASSED" << std::endl << std::endl;
+
+    // Test 3: Maximum Height
+    constexpr double expected_max_height = 0.526;  // Expected height (m)
+    constexpr double max_height_output =
+        projectile::round_3(projectile::max_height(initial_velocity, angle));
+    static_assert(
+        projectile::constexpr_abs(max_height_output - expected_max_height) < 1e-9,
+        "max_height mismatch");
+
+    std::cout << "Projectile Max Height (m)" << std::endl;
+    std::cout << "Initial Velocity: " << initial_velocity << " m/s" << std::endl;
+    std::cout << "Launch Angle: " << angle << " degrees" << std::endl;
+    std::cout << "Expected Output: " << expected_max_height << " m" << std::endl;
+    std::cout << "Output: " << max_height_output << " m" << std::endl;
+    std::cout << "TEST PASSED" << std::endl << std::endl;
+
+    // Test 4: fused solve() agrees with the individual entry points.
+    // Compared with a tolerance rather than bit-exactly: under fast-math the
+    // runtime rounding helpers divide by a reciprocal, which can differ from
+    // the exact constexpr result by one ulp.
+    const projectile::ProjectileSolution solution =
+        projectile::solve(initial_velocity, angle);
+    assert(projectile::constexpr_abs(projectile::round_3(solution.time) -
+                                     flight_time_output) < 1e-9);
+    assert(projectile::constexpr_abs(projectile::round_2(solution.range) -
+                                     horizontal_range_output) < 1e-9);
+    assert(projectile::constexpr_abs(projectile::round_3(solution.height) -
+                                     max_height_output) < 1e-9);
+
+    std::cout << "Fused Projectile Solve" << std::endl;
+    std::cout << "Time of Flight: " << solution.time << " s" << std::endl;
+    std::cout << "Horizontal Range: " << solution.range << " m" << std::endl;
+    std::cout << "Max Height: " << solution.height << " m" << std::endl;
+    std::cout << "TEST PASSED" << std::endl << std::endl;
+}
+
+/**
+ * @brief Main function
+ * @returns 0 on exit
+ */
+int main() {
+    test();  // Run self-tests
+    return 0;
+}